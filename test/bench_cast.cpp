@@ -0,0 +1,86 @@
+// Benchmark of numeric casts of arrays of measures.
+// The function "cast_per_element" casts every point by the function cast,
+// the function "cast_bulk" casts the whole array by the function cast_n,
+// and the function "cast_raw" casts an array of primitive numbers.
+// The function "round_bulk" rounds to the nearest integer;
+// on x86 processors, it is compiled inline only when SSE4.1 is enabled.
+#define MEASURES_USE_ALL
+#include "measures.hpp"
+using namespace measures;
+
+MEASURES_MAGNITUDE(Length, meters, " m")
+MEASURES_UNIT(mm, Length, " mm", 0.001, 0)
+
+#include <ctime>
+#include <cstdio>
+using namespace std;
+
+int const size = 1000;
+
+void cast_per_element(point3<mm,float> const a[], point3<mm,double> b[])
+{
+	for (int i = 0; i < size; ++i) b[i] = cast<double>(a[i]);
+}
+
+void cast_bulk(point3<mm,float> const a[], point3<mm,double> b[])
+{
+	cast_n<double>(size, a, b);
+}
+
+void cast_raw(float const a[], double b[])
+{
+	for (int i = 0; i < size * 3; ++i) b[i] = a[i];
+}
+
+void round_bulk(point3<mm,double> const a[], point3<mm,int> b[])
+{
+	cast_n<int>(size, a, b, rounding_mode::to_nearest);
+}
+
+int main()
+{
+	clock_t start;
+	const int n_iterations = 1000000;
+	static point3<mm,float> a[size];
+	static point3<mm,double> b[size];
+	static point3<mm,int> c[size];
+	static float d[size * 3];
+	static double e[size * 3];
+	for (int i = 0; i < size; ++i) a[i] = point3<mm,float>(i, i + 1, i + 2);
+
+	printf("cast_per_element > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		cast_per_element(a, b);
+		a[i1 % size] = cast<float>(b[(i1 + 1) % size]);
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("cast_bulk > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		cast_bulk(a, b);
+		a[i1 % size] = cast<float>(b[(i1 + 1) % size]);
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("cast_raw > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		cast_raw(d, e);
+		d[i1 % size] = e[(i1 + 1) % size];
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("round_bulk > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		round_bulk(b, c);
+		b[i1 % size] = cast<double>(c[(i1 + 1) % size]);
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+}
@@ -0,0 +1,122 @@
+// Benchmark of unit conversions that do not change values.
+// Compiling this file with "-O2 -S", the code generated for
+// the functions "convert_same_unit", "convert_same_ratio",
+// "convert_temperature_vects" and "copy_raw" contains only copies,
+// as such conversions are detected at compile time.
+// The functions "convert_points_n" and "convert_points_raw" compare
+// the bulk conversion of temperature points with the same loop
+// written on primitive numbers.
+#define MEASURES_USE_ALL
+#include "measures.hpp"
+using namespace measures;
+
+MEASURES_MAGNITUDE(Length, meters, " m")
+MEASURES_UNIT(mm, Length, " mm", 0.001, 0)
+MEASURES_UNIT(millimetres, Length, " mm", 0.001, 0)
+MEASURES_MAGNITUDE(Temperature, kelvin, "^K")
+MEASURES_UNIT(celsius, Temperature, "^C", 1, 273.15)
+MEASURES_UNIT(fahrenheit, Temperature, "^F", 5. / 9., 273.15 - 32. * 5. / 9.)
+
+#include <ctime>
+#include <cstdio>
+using namespace std;
+
+int const size = 1000;
+
+void convert_same_unit(point3<mm,float> const a[], point3<mm,float> b[])
+{
+	for (int i = 0; i < size; ++i) b[i] = convert<mm>(a[i]);
+}
+
+void convert_same_ratio(point3<mm,float> const a[],
+	point3<millimetres,float> b[])
+{
+	for (int i = 0; i < size; ++i) b[i] = convert<millimetres>(a[i]);
+}
+
+void copy_raw(float const a[], float b[])
+{
+	for (int i = 0; i < size * 3; ++i) b[i] = a[i];
+}
+
+// Vects of kelvin and of celsius have the same ratio,
+// and so only points need a conversion.
+void convert_temperature_vects(vect1<kelvin,float> const a[],
+	vect1<celsius,float> b[])
+{
+	for (int i = 0; i < size; ++i) b[i] = convert<celsius>(a[i]);
+}
+
+void convert_points_n(point1<fahrenheit,float> const a[],
+	point1<kelvin,float> b[])
+{
+	convert_n<kelvin>(size, a, b);
+}
+
+void convert_points_raw(float const a[], float b[])
+{
+	float const ratio = 5.f / 9.f;
+	float const offset = 273.15f - 32.f * 5.f / 9.f;
+	for (int i = 0; i < size; ++i) b[i] = a[i] * ratio + offset;
+}
+
+int main()
+{
+	clock_t start;
+	const int n_iterations = 1000000;
+	static point3<mm,float> a[size];
+	static point3<mm,float> b[size];
+	static point3<millimetres,float> c[size];
+	static float d[size * 3];
+	static float e[size * 3];
+	for (int i = 0; i < size; ++i) a[i] = point3<mm,float>(i, i + 1, i + 2);
+
+	printf("convert_same_unit > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		convert_same_unit(a, b);
+		a[i1 % size] = b[(i1 + 1) % size];
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("convert_same_ratio > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		convert_same_ratio(a, c);
+		a[i1 % size] = point3<mm,float>(c[(i1 + 1) % size].data());
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("copy_raw > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		copy_raw(d, e);
+		d[i1 % size] = e[(i1 + 1) % size];
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	static point1<fahrenheit,float> f[size];
+	static point1<kelvin,float> k[size];
+	for (int i = 0; i < size; ++i) f[i] = point1<fahrenheit,float>(i);
+
+	printf("convert_points_n > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		convert_points_n(f, k);
+		f[i1 % size] = point1<fahrenheit,float>(k[(i1 + 1) % size].value());
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+
+	printf("convert_points_raw > ");
+	start = clock();
+	for (int i1 = 0; i1 < n_iterations; ++i1)
+	{
+		convert_points_raw(d, e);
+		d[i1 % size] = e[(i1 + 1) % size];
+	}
+	printf("%f ns per iteration\n", (clock() - start) * 1.e9 / n_iterations / CLOCKS_PER_SEC);
+}
@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include <complex>
+#include <cfenv>
 #define MEASURES_USE_ALL
+#if __cplusplus >= 201402L
+#define MEASURES_USE_CONSTEXPR
+#endif
 #include "measures.hpp"
 using namespace measures;
 using namespace std;
@@ -8,12 +12,16 @@ using namespace std;
 MEASURES_MAGNITUDE(Space, metres, " m")
 MEASURES_ANGLE_UNIT(degrees, "^", 360, 0)
 MEASURES_ANGLE_UNIT(turns, " rev", 1, 0)
+MEASURES_ANGLE_UNIT(degrees_from_y, "^y", 360, pi / 2)
 #define AZIMUTH_TOLERANCE 0.00002f
 #define MIN_THRESHOLD 1e-14
 #define MAX_THRESHOLD 1e14
 
 MEASURES_UNIT(km, Space, " Km", 1000, 0)
 MEASURES_UNIT(inches, Space, "\"", 0.0254, 0)
+MEASURES_UNIT(mm, Space, " mm", 0.001, 0)
+MEASURES_UNIT(um, Space, " um", 0.000001, 0)
+MEASURES_UNIT(nm, Space, " nm", 0.000000001, 0)
 
 MEASURES_MAGNITUDE(Time, seconds, " s")
 MEASURES_UNIT(hours, Time, " h", 3600, 0)
@@ -83,7 +91,8 @@ template <typename Num1, typename Num2>
 decltype(Num1()/Num2()) modulo(Num1 a, Num2 b)
 {
   const auto result = fmod(a, b);
-  return result >= 0 ? result : result + b;
+  const auto positive = result >= 0 ? result : result + b;
+  return positive < b ? positive : 0;
 }
 
 // These are all the supported inner types
@@ -140,6 +149,10 @@ TEST(general_test, turn)
 	EXPECT_FLOAT_EQ(360, degrees::id().turn_fraction<int>());
 	EXPECT_FLOAT_EQ(2 * pi, radians::id().turn_fraction<long double>());
 	EXPECT_FLOAT_EQ(1, turns::id().turn_fraction<int>());
+
+	static_assert(degrees::turn_fraction<int>() == 360, "");
+	static_assert(degrees::id().turn_fraction<int>() == 360, "");
+	static_assert(radians::id().ratio() == 1, "");
 }
 
 TYPED_TEST(general_test, vect1)
@@ -2404,6 +2417,47 @@ TYPED_TEST(fractional_test, affine_map3)
     }
 }
 
+TYPED_TEST(fractional_test, bulk_maps3)
+{
+    auto am = affine_map3<metres,TypeParam>::rotation(
+        point3<metres,TypeParam>(-3.2L, -7.9L, 1.5L),
+        normalized(vect3<metres,TypeParam>(1.9L, -5.4L, -0.7L)),
+        vect1<radians,TypeParam>(0.3L));
+    auto lm = linear_map3<TypeParam>::scaling(2, -3, 0.5L);
+    int const n = 5;
+    point3<metres,TypeParam> points[n], mapped_points[n];
+    vect3<metres,TypeParam> vects[n], mapped_vects[n];
+    for (int i = 0; i < n; ++i)
+    {
+        points[i] = point3<metres,TypeParam>(17.8L + i, 13.3L, -2.7L * i);
+        vects[i] = vect3<metres,TypeParam>(1.25L * i, -0.5L, 7);
+    }
+
+    // Same values of mapped_by.
+    map_points(am, n, points, mapped_points);
+    map_vects(lm, n, vects, mapped_vects);
+    for (int i = 0; i < n; ++i)
+    {
+        auto p = points[i].mapped_by(am);
+        EQUAL(p.x().value(), mapped_points[i].x())
+        EQUAL(p.y().value(), mapped_points[i].y())
+        EQUAL(p.z().value(), mapped_points[i].z())
+        auto v = vects[i].mapped_by(lm);
+        EQUAL(v.x().value(), mapped_vects[i].x())
+        EQUAL(v.y().value(), mapped_vects[i].y())
+        EQUAL(v.z().value(), mapped_vects[i].z())
+    }
+
+    // In place.
+    map_points(am, n, points, points);
+    map_vects(lm, n, vects, vects);
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_TRUE(points[i] == mapped_points[i]);
+        EXPECT_TRUE(vects[i] == mapped_vects[i]);
+    }
+}
+
 TYPED_TEST(general_test, vect3)
 {
 	auto epsilon = numeric_limits<TypeParam>::is_integer ?
@@ -3301,6 +3355,23 @@ TEST(unitTest, magnitudes)
 	EXPECT_EQ(273.15 - 32. * 5. / 9., fahrenheit::id().offset());
 }
 
+TEST(unitTest, unit_identity)
+{
+	EXPECT_TRUE(inches::id() == inches::id());
+	EXPECT_TRUE(Space(&inches_features_) == inches::id());
+	EXPECT_FALSE(inches::id() == metres::id());
+	EXPECT_TRUE(inches::id() != km::id());
+	EXPECT_TRUE(degrees::id() == degrees::id());
+	EXPECT_TRUE(degrees::id() != radians::id());
+
+	// Dynamic units equal to the static unit only cast the value.
+	EXPECT_EQ(0.1f, (vect1<inches,float>(inches::id(), 0.1f).value()));
+	EXPECT_EQ(0.1, point1<celsius>(celsius::id(), 0.1).value(celsius::id()));
+	EXPECT_EQ(0.1f, (point3<km,float>(km::id(), 0.1f, 0.2f, 0.3f).x().value()));
+	EXPECT_FLOAT_EQ(273.25, point1<celsius>(celsius::id(), 0.1).value(kelvin::id()));
+	EXPECT_FLOAT_EQ(0.1, point1<kelvin>(celsius::id(), 0.1).value(celsius::id()));
+}
+
 TEST(unitTest, units)
 {
 	ASSERT_STREQ(" rad", radians::suffix());
@@ -3395,6 +3466,10 @@ TEST(unitTest, vect_conversions)
 	EXPECT_FLOAT_EQ(101. / 9 * 5, convert<celsius>(vect1<fahrenheit>(101)).value());
 	EXPECT_FLOAT_EQ(101. / 5 * 9, convert<fahrenheit>(vect1<celsius>(101)).value());
 
+	EXPECT_FLOAT_EQ(101.f / 0.0254f, convert<inches>(vect1<metres,float>(101)).value());
+	EXPECT_FLOAT_EQ(101.f * 0.0254f, convert<metres>(vect1<inches,float>(101)).value());
+	EXPECT_EQ(101000, convert<metres>(vect1<km,int>(101)).value());
+
 	auto a1 = convert<inches>(vect2<metres>(101, 102));
 	EXPECT_FLOAT_EQ(101. / 0.0254, a1.x().value());
 	EXPECT_FLOAT_EQ(102. / 0.0254, a1.y().value());
@@ -3433,6 +3508,19 @@ TEST(unitTest, point_conversions)
 	EXPECT_FLOAT_EQ((101. - 32) / 9 * 5, convert<celsius>(point1<fahrenheit>(101)).value());
 	EXPECT_FLOAT_EQ(101. / 5 * 9 + 32, convert<fahrenheit>(point1<celsius>(101)).value());
 
+	EXPECT_FLOAT_EQ(101.f - 273.15f, convert<celsius>(point1<kelvin,float>(101)).value());
+	EXPECT_FLOAT_EQ(101.f / 5 * 9 + 32, convert<fahrenheit>(point1<celsius,float>(101)).value());
+
+	auto am2 = convert<inches>(affine_map2<metres>::translation(vect2<metres>(1, 2)));
+	EXPECT_FLOAT_EQ(1, am2.coeff(0, 0));
+	EXPECT_FLOAT_EQ(1. / 0.0254, am2.coeff(0, 2));
+	EXPECT_FLOAT_EQ(2. / 0.0254, am2.coeff(1, 2));
+
+	auto am3 = convert<inches>(affine_map3<metres>::translation(vect3<metres>(1, 2, 3)));
+	EXPECT_FLOAT_EQ(1, am3.coeff(2, 2));
+	EXPECT_FLOAT_EQ(1. / 0.0254, am3.coeff(0, 3));
+	EXPECT_FLOAT_EQ(3. / 0.0254, am3.coeff(2, 3));
+
 	auto a1 = convert<inches>(point2<metres>(101, 102));
 	EXPECT_FLOAT_EQ(101. / 0.0254, a1.x().value());
 	EXPECT_FLOAT_EQ(102. / 0.0254, a1.y().value());
@@ -3469,6 +3557,1233 @@ TEST(unitTest, azimuth_conversions)
 	EXPECT_FLOAT_EQ(fmod(1010.3 * 360, 360.), convert<degrees>(unsigned_azimuth<turns>(1010.3)).value());
 }
 
+TEST(unitTest, identity_conversions)
+{
+	// Conversions that do not change values return them unaltered.
+	EXPECT_EQ(0.1f, convert<inches>(vect1<inches,float>(0.1f)).value());
+	EXPECT_EQ(0.1f, convert<kelvin>(vect1<celsius,float>(0.1f)).value());
+	EXPECT_TRUE(std::signbit(convert<celsius>(point1<celsius>(-0.)).value()));
+	EXPECT_EQ(0.1, convert<celsius>(point1<celsius>(0.1)).value());
+
+	auto a1 = convert<metres>(point3<metres,float>(0.1f, 0.2f, 0.3f));
+	EXPECT_EQ(0.1f, a1.x().value());
+	EXPECT_EQ(0.2f, a1.y().value());
+	EXPECT_EQ(0.3f, a1.z().value());
+
+	auto a2 = convert<metres>(affine_map3<metres>::translation(vect3<metres>(0.1, 0.2, 0.3)));
+	EXPECT_EQ(0.1, a2.coeff(0, 3));
+	EXPECT_EQ(0.3, a2.coeff(2, 3));
+
+	EXPECT_EQ(0.1, convert<degrees>(signed_azimuth<degrees>(0.1)).value());
+	EXPECT_EQ(359.9, convert<degrees>(unsigned_azimuth<degrees>(359.9)).value());
+}
+
+TEST(unitTest, bulk_conversions)
+{
+	point1<fahrenheit,float> f[3] = { point1<fahrenheit,float>(32),
+		point1<fahrenheit,float>(212), point1<fahrenheit,float>(50) };
+	point1<celsius,float> c[3];
+	convert_n<celsius>(3, f, c);
+	EXPECT_NEAR(0, c[0].value(), 1e-5);
+	EXPECT_FLOAT_EQ(100, c[1].value());
+	EXPECT_FLOAT_EQ(10, c[2].value());
+
+	vect1<fahrenheit,float> df[2] = { vect1<fahrenheit,float>(90),
+		vect1<fahrenheit,float>(-18) };
+	vect1<celsius,float> dc[2];
+	convert_n<celsius>(2, df, dc);
+	EXPECT_FLOAT_EQ(50, dc[0].value());
+	EXPECT_FLOAT_EQ(-10, dc[1].value());
+
+	// The same results of the single conversions.
+	point3<inches> p[2] = { point3<inches>(1, 2, 3), point3<inches>(4, 5, 6) };
+	point3<km> pk[2];
+	convert_n<km>(2, p, pk);
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(convert<km>(p[i]).x().value(), pk[i].x().value());
+		EXPECT_EQ(convert<km>(p[i]).y().value(), pk[i].y().value());
+		EXPECT_EQ(convert<km>(p[i]).z().value(), pk[i].z().value());
+	}
+	vect2<km> v[1] = { vect2<km>(1, -2) };
+	vect2<inches> vi[1];
+	convert_n<inches>(1, v, vi);
+	EXPECT_EQ(convert<inches>(v[0]).y().value(), vi[0].y().value());
+
+	// In-place conversion.
+	point1<kelvin> t[2] = { point1<kelvin>(0), point1<kelvin>(300) };
+	convert_n<celsius>(2, t, reinterpret_cast<point1<celsius>*>(t));
+	EXPECT_FLOAT_EQ(-273.15, t[0].value());
+	EXPECT_FLOAT_EQ(26.85, t[1].value());
+
+	unsigned_azimuth<degrees> a[2] = { unsigned_azimuth<degrees>(90),
+		unsigned_azimuth<degrees>(-180) };
+	unsigned_azimuth<radians> r[2];
+	convert_n<radians>(2, a, r);
+	EXPECT_FLOAT_EQ(pi / 2, r[0].value());
+	EXPECT_FLOAT_EQ(pi, r[1].value());
+}
+
+TEST(unitTest, bulk_casts)
+{
+	// Widening gives the same results of the single casts.
+	point3<inches,float> pf[2] = { point3<inches,float>(1.1f, 2.2f, 3.3f),
+		point3<inches,float>(-4.4f, 5.5f, -6.6f) };
+	point3<inches,double> pd[2];
+	cast_n<double>(2, pf, pd);
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(cast<double>(pf[i]).x().value(), pd[i].x().value());
+		EXPECT_EQ(cast<double>(pf[i]).z().value(), pd[i].z().value());
+	}
+	vect2<inches,float> vf[1];
+	vect2<inches,double> vd[1] = { vect2<inches,double>(0.1, -0.2) };
+	cast_n<float>(1, vd, vf);
+	EXPECT_EQ(0.1f, vf[0].x().value());
+	EXPECT_EQ(-0.2f, vf[0].y().value());
+
+	// Rounding modes for integral types.
+	vect1<inches> v[4] = { vect1<inches>(2.5), vect1<inches>(-2.5),
+		vect1<inches>(3.7), vect1<inches>(-3.7) };
+	vect1<inches,int> r[4];
+	cast_n<int>(4, v, r);
+	EXPECT_EQ(2, r[0].value());
+	EXPECT_EQ(-2, r[1].value());
+	EXPECT_EQ(3, r[2].value());
+	EXPECT_EQ(-3, r[3].value());
+	cast_n<int>(4, v, r, rounding_mode::to_nearest);
+	EXPECT_EQ(2, r[0].value());
+	EXPECT_EQ(-2, r[1].value());
+	EXPECT_EQ(4, r[2].value());
+	EXPECT_EQ(-4, r[3].value());
+	cast_n<int>(4, v, r, rounding_mode::downward);
+	EXPECT_EQ(2, r[0].value());
+	EXPECT_EQ(-3, r[1].value());
+	EXPECT_EQ(3, r[2].value());
+	EXPECT_EQ(-4, r[3].value());
+	cast_n<int>(4, v, r, rounding_mode::upward);
+	EXPECT_EQ(3, r[0].value());
+	EXPECT_EQ(-2, r[1].value());
+	EXPECT_EQ(4, r[2].value());
+	EXPECT_EQ(-3, r[3].value());
+
+	// Halfway cases are rounded to even in any floating-point mode.
+	int const mode = fegetround();
+	fesetround(FE_UPWARD);
+	cast_n<int>(4, v, r, rounding_mode::to_nearest);
+	fesetround(mode);
+	EXPECT_EQ(2, r[0].value());
+	EXPECT_EQ(-2, r[1].value());
+	EXPECT_EQ(4, r[2].value());
+	EXPECT_EQ(-4, r[3].value());
+
+	// Integers are cast exactly.
+	vect1<inches,long long> big[1] = {
+		vect1<inches,long long>(9007199254740993LL) };
+	vect1<inches,long long> big_result[1];
+	cast_n<long long>(1, big, big_result, rounding_mode::to_nearest);
+	EXPECT_EQ(9007199254740993LL, big_result[0].value());
+
+	// The rounding mode is ignored for floating-point types.
+	point1<inches,float> pr[1];
+	point1<inches> p[1] = { point1<inches>(2.5) };
+	cast_n<float>(1, p, pr, rounding_mode::upward);
+	EXPECT_EQ(2.5f, pr[0].value());
+
+	// The rounded azimuths are normalized.
+	unsigned_azimuth<degrees> a[2] = { unsigned_azimuth<degrees>(359.6),
+		unsigned_azimuth<degrees>(10.2) };
+	unsigned_azimuth<degrees,int> ai[2];
+	cast_n<int>(2, a, ai, rounding_mode::to_nearest);
+	EXPECT_EQ(0, ai[0].value());
+	EXPECT_EQ(10, ai[1].value());
+}
+
+TEST(unitTest, bulk_azimuth_normalizations)
+{
+	// The same results of the constructors, within the documented tolerance.
+	double values[8] = { 0, 179.9, 180, -180, 540.5, -1e-20, 1e6 + 0.25, -725 };
+	signed_azimuth<degrees> s[8];
+	unsigned_azimuth<degrees> u[8];
+	normalize_n(8, values, s);
+	normalize_n(8, values, u);
+	for (int i = 0; i < 8; ++i)
+	{
+		double one_turn = 360;
+		double exact = fmod(values[i], one_turn);
+		if (exact < 0) exact += one_turn;
+		double tolerance = (abs(values[i]) + one_turn)
+			* numeric_limits<double>::epsilon();
+		EXPECT_NEAR(0, angle_distance(unsigned_azimuth<degrees>(exact), u[i]).value(), tolerance);
+		EXPECT_NEAR(0, angle_distance(signed_azimuth<degrees>(exact), s[i]).value(), tolerance);
+		EXPECT_EQ(signed_azimuth<degrees>(values[i]).value(), s[i].value());
+		EXPECT_EQ(unsigned_azimuth<degrees>(values[i]).value(), u[i].value());
+		EXPECT_LE(-180, s[i].value());
+		EXPECT_GT(180, s[i].value());
+		EXPECT_LE(0, u[i].value());
+		EXPECT_GT(360, u[i].value());
+	}
+	EXPECT_EQ(179.9, s[1].value());
+	EXPECT_EQ(-180, s[2].value());
+	EXPECT_EQ(-180, s[3].value());
+	EXPECT_EQ(-179.5, s[4].value());
+	EXPECT_EQ(0, u[5].value());
+	EXPECT_EQ(355, u[7].value());
+
+	// Points in place.
+	point1<radians,float> p[2] = { point1<radians,float>(7),
+		point1<radians,float>(-7) };
+	normalize_n(2, p, reinterpret_cast<unsigned_azimuth<radians,float>*>(p));
+	EXPECT_FLOAT_EQ(7 - 2 * pi, p[0].value());
+	EXPECT_FLOAT_EQ(4 * pi - 7, p[1].value());
+
+	// Integral numbers.
+	int degrees_values[3] = { 190, -190, 720 };
+	signed_azimuth<degrees,int> si[3];
+	normalize_n(3, degrees_values, si);
+	EXPECT_EQ(-170, si[0].value());
+	EXPECT_EQ(170, si[1].value());
+	EXPECT_EQ(0, si[2].value());
+
+	// Infinities and NaNs are normalized to zero.
+	double special[2] = { numeric_limits<double>::infinity(),
+		numeric_limits<double>::quiet_NaN() };
+	normalize_n(2, special, u);
+	EXPECT_EQ(0, u[0].value());
+	EXPECT_EQ(0, u[1].value());
+}
+
+TEST(unitTest, binary_angles)
+{
+	EXPECT_EQ(65536, bam_unit<16>::turn_fraction<int>());
+	EXPECT_FLOAT_EQ(90, (convert<degrees>(vect1<bam_unit<16>,float>(16384)).value()));
+
+	// Wraparound by overflow.
+	bam_azimuth<16> a(65000);
+	a += vect1<bam_unit<16>,int>(1000);
+	EXPECT_EQ(464, a.value());
+	a -= vect1<bam_unit<16>,int>(465);
+	EXPECT_EQ(65535, a.value());
+	EXPECT_EQ(-1, a.signed_value());
+	bam_azimuth<8> b(200);
+	EXPECT_EQ(-56, b.signed_value());
+	EXPECT_EQ(10, (b + vect1<bam_unit<8>,int>(66)).value());
+	EXPECT_EQ(190, (b - vect1<bam_unit<8>,int>(10)).value());
+
+	// The shortest difference.
+	EXPECT_EQ(2, (bam_azimuth<16>(1) - bam_azimuth<16>(65535)).value());
+	EXPECT_EQ(-2, (bam_azimuth<16>(65535) - bam_azimuth<16>(1)).value());
+	EXPECT_TRUE(bam_azimuth<16>(3) == bam_azimuth<16>(3));
+	EXPECT_TRUE(bam_azimuth<16>(3) != bam_azimuth<16>(4));
+
+	// Conversions.
+	EXPECT_EQ(16384, bam_azimuth<16>(unsigned_azimuth<degrees>(90)).value());
+	EXPECT_EQ(49152, bam_azimuth<16>(signed_azimuth<degrees>(-90)).value());
+	EXPECT_EQ(0, bam_azimuth<16>(unsigned_azimuth<degrees>(359.999)).value());
+	EXPECT_EQ(1u << 31, bam_azimuth<32>(signed_azimuth<radians>(-pi)).value());
+	EXPECT_EQ(64, bam_azimuth<8>(unsigned_azimuth<degrees,int>(90)).value());
+	EXPECT_FLOAT_EQ(-90, (to_signed_azimuth<degrees>(bam_azimuth<16>(49152)).value()));
+	EXPECT_FLOAT_EQ(270, (to_unsigned_azimuth<degrees,float>(bam_azimuth<16>(49152)).value()));
+	EXPECT_FLOAT_EQ(-pi / 2, (to_signed_azimuth<radians>(bam_azimuth<32>(3u << 30)).value()));
+
+	// Table-based sine and cosine.
+	for (unsigned i = 0; i < 65536; i += 97)
+	{
+		bam_azimuth<16> c(static_cast<std::uint16_t>(i));
+		double const angle = i * (2 * pi / 65536);
+		EXPECT_NEAR(std::sin(angle), sin(c), 1.3e-6);
+		EXPECT_NEAR(std::cos(angle), cos(c), 1.3e-6);
+	}
+	EXPECT_NEAR(1, sin(bam_azimuth<8>(64)), 1e-7);
+	EXPECT_NEAR(-1, cos(bam_azimuth<32>(1u << 31)), 1e-7);
+}
+
+TEST(unitTest, bulk_trigonometric_functions)
+{
+	int const n = 1000;
+	point1<degrees> points[n];
+	vect1<degrees> vects[n];
+	signed_azimuth<degrees> signed_azimuths[n];
+	unsigned_azimuth<degrees> unsigned_azimuths[n];
+	for (int i = 0; i < n; ++i)
+	{
+		double const x = -900 + 1.8 * i + 0.123;
+		points[i] = point1<degrees>(x);
+		vects[i] = vect1<degrees>(x);
+		signed_azimuths[i] = signed_azimuth<degrees>(x);
+		unsigned_azimuths[i] = unsigned_azimuth<degrees>(x);
+	}
+	double sines[n], cosines[n], tangents[n];
+
+	// The full accuracy gives the same results of the scalar functions.
+	sincos_n(n, points, sines, cosines);
+	tan_n(n, signed_azimuths, tangents);
+	for (int i = 0; i < n; ++i)
+	{
+		EXPECT_EQ(sin(points[i]), sines[i]);
+		EXPECT_EQ(cos(points[i]), cosines[i]);
+		EXPECT_EQ(tan(signed_azimuths[i]), tangents[i]);
+	}
+
+	trig_accuracy const accuracies[2] = {
+		trig_accuracy::absolute_1e7, trig_accuracy::absolute_1e4 };
+	double const tolerances[2] = { 1e-7, 1e-4 };
+	for (int a = 0; a < 2; ++a)
+	{
+		double const tolerance = tolerances[a];
+		sin_n(n, vects, sines, accuracies[a]);
+		cos_n(n, vects, cosines, accuracies[a]);
+		for (int i = 0; i < n; ++i)
+		{
+			EXPECT_NEAR(sin(vects[i]), sines[i], tolerance);
+			EXPECT_NEAR(cos(vects[i]), cosines[i], tolerance);
+		}
+		sincos_n(n, signed_azimuths, sines, cosines, accuracies[a]);
+		for (int i = 0; i < n; ++i)
+		{
+			EXPECT_NEAR(sin(signed_azimuths[i]), sines[i], tolerance);
+			EXPECT_NEAR(cos(signed_azimuths[i]), cosines[i], tolerance);
+		}
+		sincos_n(n, unsigned_azimuths, sines, cosines, accuracies[a]);
+		tan_n(n, unsigned_azimuths, tangents, accuracies[a]);
+		for (int i = 0; i < n; ++i)
+		{
+			EXPECT_NEAR(sin(unsigned_azimuths[i]), sines[i], tolerance);
+			EXPECT_NEAR(cos(unsigned_azimuths[i]), cosines[i], tolerance);
+			EXPECT_DOUBLE_EQ(sines[i] / cosines[i], tangents[i]);
+		}
+	}
+
+	// Exact values at the quadrant boundaries, and units with offset.
+	point1<radians,float> quadrants[4] = { point1<radians,float>(0),
+		point1<radians,float>(pi / 2), point1<radians,float>(-pi),
+		point1<radians,float>(-pi / 2) };
+	float s[4], c[4];
+	sincos_n(4, quadrants, s, c, trig_accuracy::absolute_1e4);
+	EXPECT_EQ(0, s[0]);
+	EXPECT_EQ(1, c[0]);
+	EXPECT_FLOAT_EQ(1, s[1]);
+	EXPECT_FLOAT_EQ(-1, c[2]);
+	EXPECT_FLOAT_EQ(-1, s[3]);
+
+	// The offset of the unit is added to the values.
+	point1<degrees_from_y> shifted[4] = { point1<degrees_from_y>(0),
+		point1<degrees_from_y>(90), point1<degrees_from_y>(-30),
+		point1<degrees_from_y>(1000.5) };
+	double ss[4], cs[4];
+	sincos_n(4, shifted, ss, cs);
+	for (int i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(sin(shifted[i]), ss[i]);
+		EXPECT_EQ(cos(shifted[i]), cs[i]);
+	}
+	for (int a = 0; a < 2; ++a)
+	{
+		sincos_n(4, shifted, ss, cs, accuracies[a]);
+		for (int i = 0; i < 4; ++i)
+		{
+			double const x = convert<radians>(shifted[i]).value();
+			EXPECT_NEAR(std::sin(x), ss[i], tolerances[a]);
+			EXPECT_NEAR(std::cos(x), cs[i], tolerances[a]);
+		}
+		EXPECT_NEAR(1, ss[0], tolerances[a]);
+		EXPECT_NEAR(-1, cs[1], tolerances[a]);
+	}
+}
+
+TEST(unitTest, bulk_rotations)
+{
+	vect1<degrees> angles[4] = { vect1<degrees>(0), vect1<degrees>(30),
+		vect1<degrees>(-135), vect1<degrees>(400) };
+
+	// The same maps of the single factories.
+	linear_map2<double> maps2[4];
+	make_rotations(4, angles, maps2);
+	vect3<units> axis = normalized(vect3<units>(1, -2, 2));
+	linear_map3<double> maps3[4];
+	make_rotations(axis, 4, angles, maps3);
+	for (int i = 0; i < 4; ++i)
+	{
+		linear_map2<double> map2 = make_rotation(angles[i]);
+		for (int row = 0; row < 2; ++row)
+			for (int col = 0; col < 2; ++col)
+				EXPECT_EQ(map2.coeff(row, col), maps2[i].coeff(row, col));
+		linear_map3<double> map3 = make_rotation(axis, angles[i]);
+		for (int row = 0; row < 3; ++row)
+			for (int col = 0; col < 3; ++col)
+				EXPECT_NEAR(map3.coeff(row, col), maps3[i].coeff(row, col), 1e-15);
+	}
+
+	// The approximated sines and cosines.
+	make_rotations(4, angles, maps2, trig_accuracy::absolute_1e4);
+	vect2<metres> v = vect2<metres>(2, 0).mapped_by(maps2[1]);
+	EXPECT_NEAR(sqrt(3.), v.x().value(), 2e-4);
+	EXPECT_NEAR(1, v.y().value(), 2e-4);
+
+	// The factories of unit vectors, projections, and reflections.
+	vect2<units> u = make_unit_vector<units,double>(point1<degrees>(60));
+	EXPECT_DOUBLE_EQ(0.5, u.x().value());
+	EXPECT_DOUBLE_EQ(sqrt(3.) / 2, u.y().value());
+	vect2<metres> p = vect2<metres>(2, 0).mapped_by(
+		make_projection(signed_azimuth<degrees>(45)));
+	EXPECT_DOUBLE_EQ(1, p.x().value());
+	EXPECT_DOUBLE_EQ(1, p.y().value());
+	vect2<metres> r = vect2<metres>(2, 3).mapped_by(
+		make_reflection(unsigned_azimuth<degrees>(90)));
+	EXPECT_NEAR(-2, r.x().value(), 1e-15);
+	EXPECT_DOUBLE_EQ(3, r.y().value());
+}
+
+TEST(unitTest, approximate_directions)
+{
+	int const n = 720;
+	vect2<metres> v[n + 1];
+	for (int i = 0; i < n; ++i)
+	{
+		double const a = i * (2 * pi / n) + 0.001;
+		v[i] = vect2<metres>(3 * cos(a), 3 * sin(a));
+	}
+	v[n] = vect2<metres>(0, 0);
+	signed_azimuth<degrees> s[n + 1];
+	unsigned_azimuth<degrees> u[n + 1];
+
+	// The full accuracy gives the same results of the constructors.
+	atan2_n(n + 1, v, s);
+	atan2_n(n + 1, v, u);
+	for (int i = 0; i <= n; ++i)
+	{
+		EXPECT_EQ(signed_azimuth<degrees>(v[i]).value(), s[i].value());
+		EXPECT_EQ(unsigned_azimuth<degrees>(v[i]).value(), u[i].value());
+	}
+
+	trig_accuracy const accuracies[2] = {
+		trig_accuracy::absolute_1e7, trig_accuracy::absolute_1e4 };
+	double const tolerances[2] = { 1e-7, 1e-4 };
+	for (int a = 0; a < 2; ++a)
+	{
+		double const tolerance = tolerances[a] * 180 / pi;
+		atan2_n(n + 1, v, s, accuracies[a]);
+		atan2_n(n + 1, v, u, accuracies[a]);
+		for (int i = 0; i <= n; ++i)
+		{
+			signed_azimuth<degrees> const exact_s(v[i]);
+			unsigned_azimuth<degrees> const exact_u(v[i]);
+			EXPECT_NEAR(0, angle_distance(exact_s, s[i]).value(), tolerance);
+			EXPECT_NEAR(0, angle_distance(exact_u, u[i]).value(), tolerance);
+			EXPECT_EQ(signed_azimuth<degrees>(v[i], accuracies[a]).value(),
+				s[i].value());
+			EXPECT_EQ(unsigned_azimuth<degrees>(v[i], accuracies[a]).value(),
+				u[i].value());
+		}
+		EXPECT_EQ(0, s[n].value());
+		EXPECT_EQ(0, u[n].value());
+	}
+
+	// Exact values along the axes.
+	signed_azimuth<turns,float> t(vect2<metres,float>(-1, 0),
+		trig_accuracy::absolute_1e4);
+	EXPECT_EQ(-0.5f, t.value());
+	unsigned_azimuth<radians,float> r(vect2<metres,float>(0, -2),
+		trig_accuracy::absolute_1e7);
+	EXPECT_FLOAT_EQ(1.5f * pi, r.value());
+}
+
+TEST(unitTest, rigid_map_inversions)
+{
+	vect3<metres> const dir(0.48, 0.6, 0.64);
+	vect1<degrees> const ang(37);
+	point3<metres> const fp(3, -2, 5);
+	auto const lm1 = linear_map3<double>::rotation(dir, ang);
+	auto const lm2 = linear_map3<double>::reflection_over_plane(0.6, 0.8, 0.);
+	auto const lm3 = linear_map3<double>::scaling(1, 2, 3);
+	EXPECT_TRUE(lm1.is_rigid());
+	EXPECT_TRUE(lm2.is_rigid());
+	EXPECT_FALSE(lm3.is_rigid());
+	EXPECT_TRUE(combine(lm1, lm2).is_rigid());
+	EXPECT_FALSE(combine(lm1, lm3).is_rigid());
+
+	auto lm = combine(lm1, lm2);
+	auto general_lm = lm;
+	general_lm.set_rigid(false);
+	auto const inv_lm = lm.inverted();
+	auto const general_inv_lm = general_lm.inverted();
+	EXPECT_TRUE(inv_lm.is_rigid());
+	EXPECT_FALSE(general_inv_lm.is_rigid());
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int col = 0; col < 3; ++col)
+		{
+			EXPECT_NEAR(general_inv_lm.coeff(row, col),
+				inv_lm.coeff(row, col), 1e-14);
+		}
+	}
+
+	auto const am1 = affine_map3<metres>::rotation(fp, dir, ang);
+	auto const am2 = affine_map3<metres>::translation(
+		vect3<metres>(1, 2, 3));
+	auto const am3 = affine_map3<metres>::rotation_at_left(fp, dir);
+	auto const am4 = affine_map3<metres>::projection_onto_line(fp, dir);
+	EXPECT_TRUE(am1.is_rigid());
+	EXPECT_TRUE(am2.is_rigid());
+	EXPECT_TRUE(am3.is_rigid());
+	EXPECT_FALSE(am4.is_rigid());
+	auto am = combine(combine(am1, am2), am3);
+	EXPECT_TRUE(am.is_rigid());
+	EXPECT_TRUE(convert<km>(am).is_rigid());
+	EXPECT_TRUE(cast<float>(am).is_rigid());
+	EXPECT_FALSE(combine(am, am4).is_rigid());
+
+	auto general_am = am;
+	general_am.set_rigid(false);
+	auto const inv_am = am.inverted();
+	auto const general_inv_am = general_am.inverted();
+	auto const rigid_inv_am = general_am.inverted_rigid();
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int col = 0; col < 4; ++col)
+		{
+			EXPECT_NEAR(general_inv_am.coeff(row, col),
+				inv_am.coeff(row, col), 1e-13);
+			EXPECT_EQ(inv_am.coeff(row, col),
+				rigid_inv_am.coeff(row, col));
+		}
+	}
+	point3<metres> const p(7, 8, -9);
+	point3<metres> const p2 = p.mapped_by(am).mapped_by(inv_am);
+	EXPECT_NEAR(p.x().value(), p2.x().value(), 1e-13);
+	EXPECT_NEAR(p.y().value(), p2.y().value(), 1e-13);
+	EXPECT_NEAR(p.z().value(), p2.z().value(), 1e-13);
+
+	// Reading a coefficient keeps the map rigid,
+	// while changing it requires clearing the flag.
+	auto t = am.coeff(0, 3);
+	EXPECT_TRUE(am.is_rigid());
+	am.coeff(0, 3) = t + 1;
+	EXPECT_TRUE(am.is_rigid());
+	am.coeff(0, 0) = 2;
+	am.set_rigid(false);
+	EXPECT_FALSE(am.is_rigid());
+	auto const inv_changed = am.inverted();
+	point3<metres> const p3 = p.mapped_by(am).mapped_by(inv_changed);
+	EXPECT_NEAR(p.x().value(), p3.x().value(), 1e-13);
+	EXPECT_NEAR(p.y().value(), p3.y().value(), 1e-13);
+	EXPECT_NEAR(p.z().value(), p3.z().value(), 1e-13);
+}
+
+TEST(unitTest, quaternions)
+{
+	vect3<metres> const dir(0.48, 0.6, 0.64);
+	vect3<metres> const dir2(0, 0.6, -0.8);
+	vect1<degrees> const ang(37), ang2(-112);
+	vect3<metres> const v(7, -8, 9);
+	point3<metres> const p(-3, 2, 5);
+
+	// Factories matching those of linear_map3.
+	auto const q1 = quaternion<double>::rotation(dir, ang);
+	auto const q2 = quaternion<double>::rotation(dir2, ang2);
+	auto const lm1 = linear_map3<double>::rotation(dir, ang);
+	auto const lm2 = linear_map3<double>::rotation(dir2, ang2);
+	vect3<metres> const v1 = rotate(q1, v);
+	vect3<metres> const v2 = v.mapped_by(lm1);
+	EXPECT_NEAR(v2.x().value(), v1.x().value(), 1e-13);
+	EXPECT_NEAR(v2.y().value(), v1.y().value(), 1e-13);
+	EXPECT_NEAR(v2.z().value(), v1.z().value(), 1e-13);
+	point3<metres> const p1 = rotate(quaternion<double>
+		::rotation_at_left(dir), p);
+	point3<metres> const p2 = p.mapped_by(affine_map3<metres>
+		::rotation_at_left(point3<metres>(0, 0, 0), dir));
+	EXPECT_NEAR(p2.x().value(), p1.x().value(), 1e-13);
+	EXPECT_NEAR(p2.y().value(), p1.y().value(), 1e-13);
+	EXPECT_NEAR(p2.z().value(), p1.z().value(), 1e-13);
+	vect3<metres> const v3 = rotate(quaternion<double>
+		::rotation_at_right(dir), v);
+	vect3<metres> const v4 = v.mapped_by(linear_map3<double>
+		::rotation_at_right(dir));
+	EXPECT_NEAR(v4.x().value(), v3.x().value(), 1e-13);
+	EXPECT_NEAR(v4.y().value(), v3.y().value(), 1e-13);
+	EXPECT_NEAR(v4.z().value(), v3.z().value(), 1e-13);
+
+	// Composition, inversion, and conversions to and from maps.
+	auto const q12 = combine(q1, q2);
+	auto const lm12 = combine(lm1, lm2);
+	auto const lm = to_linear_map3(q12);
+	EXPECT_TRUE(lm.is_rigid());
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int col = 0; col < 3; ++col)
+		{
+			EXPECT_NEAR(lm12.coeff(row, col), lm.coeff(row, col), 1e-14);
+		}
+	}
+	auto const q = to_quaternion(lm);
+	EXPECT_NEAR(q12.w(), q.w(), 1e-15);
+	EXPECT_NEAR(q12.x(), q.x(), 1e-15);
+	EXPECT_NEAR(q12.y(), q.y(), 1e-15);
+	EXPECT_NEAR(q12.z(), q.z(), 1e-15);
+	auto const identity = combine(q12, q12.inverted());
+	EXPECT_NEAR(1, identity.w(), 1e-15);
+	EXPECT_NEAR(0, identity.x(), 1e-15);
+	EXPECT_NEAR(0, identity.y(), 1e-15);
+	EXPECT_NEAR(0, identity.z(), 1e-15);
+
+	// Rotations by nearly half a turn use the diagonal coefficients.
+	auto const q3 = quaternion<double>::rotation(dir2, vect1<degrees>(170));
+	auto const q4 = to_quaternion(to_affine_map3(q3, p));
+	EXPECT_NEAR(q3.w(), q4.w(), 1e-15);
+	EXPECT_NEAR(q3.x(), q4.x(), 1e-15);
+	EXPECT_NEAR(q3.y(), q4.y(), 1e-15);
+	EXPECT_NEAR(q3.z(), q4.z(), 1e-15);
+	point3<metres> const p3 = p.mapped_by(to_affine_map3(q3, p));
+	EXPECT_NEAR(p.x().value(), p3.x().value(), 1e-14);
+	EXPECT_NEAR(p.y().value(), p3.y().value(), 1e-14);
+	EXPECT_NEAR(p.z().value(), p3.z().value(), 1e-14);
+
+	// Renormalization.
+	auto const q5 = normalized(quaternion<double>(2, 0, 0, 0));
+	EXPECT_EQ(1, q5.w());
+
+	// Interpolation.
+	auto const q6 = quaternion<double>::rotation(dir, vect1<degrees>(10));
+	auto const q7 = quaternion<double>::rotation(dir, vect1<degrees>(50));
+	auto const q8 = slerp(q6, q7, 0.25);
+	auto const q9 = quaternion<double>::rotation(dir, vect1<degrees>(20));
+	EXPECT_NEAR(q9.w(), q8.w(), 1e-15);
+	EXPECT_NEAR(q9.x(), q8.x(), 1e-15);
+	EXPECT_NEAR(q9.y(), q8.y(), 1e-15);
+	EXPECT_NEAR(q9.z(), q8.z(), 1e-15);
+	auto const q10 = slerp(q6, quaternion<double>(-q7.w(), -q7.x(),
+		-q7.y(), -q7.z()), 0.25);
+	EXPECT_NEAR(q9.w(), q10.w(), 1e-15);
+	EXPECT_NEAR(q9.x(), q10.x(), 1e-15);
+	auto const q11 = slerp(q6, q6, 0.5);
+	EXPECT_NEAR(q6.w(), q11.w(), 1e-15);
+	EXPECT_NEAR(q6.z(), q11.z(), 1e-15);
+
+	// Bulk rotations.
+	int const n = 3;
+	vect3<metres> vs[n] = { v, vect3<metres>(1, 0, 0), v1 };
+	point3<metres> ps[n] = { p, point3<metres>(0, 1, 0), p1 };
+	vect3<metres> vs2[n];
+	rotate_vects(q12, n, vs, vs2);
+	rotate_points(q12, n, ps, ps);
+	for (int i = 0; i < n; ++i)
+	{
+		vect3<metres> const v5 = rotate(q12, vs[i]);
+		EXPECT_NEAR(v5.x().value(), vs2[i].x().value(), 1e-13);
+		EXPECT_NEAR(v5.y().value(), vs2[i].y().value(), 1e-13);
+		EXPECT_NEAR(v5.z().value(), vs2[i].z().value(), 1e-13);
+	}
+	point3<metres> const p4 = rotate(q12, p);
+	EXPECT_NEAR(p4.x().value(), ps[0].x().value(), 1e-13);
+	EXPECT_NEAR(p4.y().value(), ps[0].y().value(), 1e-13);
+	EXPECT_NEAR(p4.z().value(), ps[0].z().value(), 1e-13);
+}
+
+TEST(unitTest, rigid_maps)
+{
+	vect3<metres> const dir(0.48, 0.6, 0.64);
+	vect3<metres> const dir2(0, 0.6, -0.8);
+	vect1<degrees> const ang(37);
+	point3<metres> const fp(3, -2, 5);
+	vect3<metres> const delta(1, 2, 3);
+	point3<metres> const p(7, 8, -9);
+
+	auto const rm1 = rigid_map3<metres>::rotation(fp, dir, ang);
+	auto const rm2 = rigid_map3<metres>::translation(delta);
+	auto const rm3 = rigid_map3<metres>::rotation_at_left(fp, dir2);
+	auto const rm4 = rigid_map3<metres>::rotation_at_right(fp, dir2);
+	auto const am1 = affine_map3<metres>::rotation(fp, dir, ang);
+	auto const am2 = affine_map3<metres>::translation(delta);
+	auto const am3 = affine_map3<metres>::rotation_at_left(fp, dir2);
+	auto const am4 = affine_map3<metres>::rotation_at_right(fp, dir2);
+	rigid_map3<metres> const rms[4] = { rm1, rm2, rm3, rm4 };
+	affine_map3<metres> const ams[4] = { am1, am2, am3, am4 };
+	for (int i = 0; i < 4; ++i)
+	{
+		point3<metres> const p1 = p.mapped_by(rms[i]);
+		point3<metres> const p2 = p.mapped_by(ams[i]);
+		EXPECT_NEAR(p2.x().value(), p1.x().value(), 1e-13);
+		EXPECT_NEAR(p2.y().value(), p1.y().value(), 1e-13);
+		EXPECT_NEAR(p2.z().value(), p1.z().value(), 1e-13);
+	}
+	EXPECT_LT(sizeof rm1, sizeof am1);
+
+	// Composition and inversion.
+	auto const rm = combine(combine(rm1, rm2), rm3);
+	auto const am = combine(combine(am1, am2), am3);
+	point3<metres> const p3 = p.mapped_by(rm);
+	point3<metres> const p4 = p.mapped_by(am);
+	EXPECT_NEAR(p4.x().value(), p3.x().value(), 1e-13);
+	EXPECT_NEAR(p4.y().value(), p3.y().value(), 1e-13);
+	EXPECT_NEAR(p4.z().value(), p3.z().value(), 1e-13);
+	point3<metres> const p5 = p3.mapped_by(rm.inverted());
+	EXPECT_NEAR(p.x().value(), p5.x().value(), 1e-13);
+	EXPECT_NEAR(p.y().value(), p5.y().value(), 1e-13);
+	EXPECT_NEAR(p.z().value(), p5.z().value(), 1e-13);
+	point3<metres> const p6 = p.mapped_by(rigid_map3<metres>::identity());
+	EXPECT_EQ(p.x().value(), p6.x().value());
+	EXPECT_EQ(p.z().value(), p6.z().value());
+
+	// Conversions.
+	auto const am5 = to_affine_map3(rm);
+	EXPECT_TRUE(am5.is_rigid());
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int col = 0; col < 4; ++col)
+		{
+			EXPECT_NEAR(am.coeff(row, col), am5.coeff(row, col), 1e-13);
+		}
+	}
+	point3<metres> const p7 = p.mapped_by(to_rigid_map3(am));
+	EXPECT_NEAR(p4.x().value(), p7.x().value(), 1e-13);
+	EXPECT_NEAR(p4.y().value(), p7.y().value(), 1e-13);
+	EXPECT_NEAR(p4.z().value(), p7.z().value(), 1e-13);
+	auto const rm_km = convert<km>(rm);
+	EXPECT_EQ(rm.rotation_part().w(), rm_km.rotation_part().w());
+	EXPECT_NEAR(rm.translation_part().x().value() / 1000,
+		rm_km.translation_part().x().value(), 1e-16);
+	point3<km> const p8 = convert<km>(p).mapped_by(rm_km);
+	EXPECT_NEAR(p3.x().value() / 1000, p8.x().value(), 1e-16);
+	EXPECT_NEAR(p3.y().value() / 1000, p8.y().value(), 1e-16);
+	EXPECT_NEAR(p3.z().value() / 1000, p8.z().value(), 1e-16);
+
+	// Bulk mapping.
+	int const n = 3;
+	point3<metres> ps[n] = { p, fp, p3 };
+	point3<metres> ps2[n];
+	map_points(rm, n, ps, ps2);
+	for (int i = 0; i < n; ++i)
+	{
+		point3<metres> const p9 = ps[i].mapped_by(rm);
+		EXPECT_NEAR(p9.x().value(), ps2[i].x().value(), 1e-13);
+		EXPECT_NEAR(p9.y().value(), ps2[i].y().value(), 1e-13);
+		EXPECT_NEAR(p9.z().value(), ps2[i].z().value(), 1e-13);
+	}
+}
+
+TEST(unitTest, transform_chains)
+{
+	vect3<metres> const dir(0.48, 0.6, 0.64);
+	point3<metres> const fp(3, -2, 5);
+	point3<metres> const p(7, 8, -9);
+	affine_map3<metres> const stages[5] = {
+		affine_map3<metres>::translation(vect3<metres>(1, 2, 3)),
+		affine_map3<metres>::rotation(fp, dir, vect1<degrees>(37)),
+		affine_map3<metres>::translation(vect3<metres>(0.1, 0, -0.2)),
+		affine_map3<metres>::reflection_over_plane(0.6, 0., 0.8, 1.),
+		affine_map3<metres>::scaling(fp, 2, 2, 2) };
+	transform_chain<affine_map3<metres>,8> chain;
+	EXPECT_EQ(0, chain.size());
+	for (int i = 0; i < 5; ++i)
+	{
+		EXPECT_EQ(i, chain.push_back(stages[i]));
+	}
+	EXPECT_EQ(5, chain.size());
+	EXPECT_FALSE(chain.map().is_rigid());
+	point3<metres> p1 = p;
+	for (int i = 0; i < 5; ++i) p1 = p1.mapped_by(stages[i]);
+	point3<metres> p2 = p.mapped_by(chain.map());
+	EXPECT_NEAR(p1.x().value(), p2.x().value(), 1e-12);
+	EXPECT_NEAR(p1.y().value(), p2.y().value(), 1e-12);
+	EXPECT_NEAR(p1.z().value(), p2.z().value(), 1e-12);
+
+	// Replacing a stage.
+	auto const correction
+		= affine_map3<metres>::translation(vect3<metres>(0, 0.3, 0));
+	chain.replace(2, correction);
+	EXPECT_EQ(correction.coeff(1, 3), chain.stage(2).coeff(1, 3));
+	p1 = p;
+	for (int i = 0; i < 5; ++i)
+	{
+		p1 = p1.mapped_by(i == 2 ? correction : stages[i]);
+	}
+	p2 = p.mapped_by(chain.map());
+	EXPECT_NEAR(p1.x().value(), p2.x().value(), 1e-12);
+	EXPECT_NEAR(p1.y().value(), p2.y().value(), 1e-12);
+	EXPECT_NEAR(p1.z().value(), p2.z().value(), 1e-12);
+
+	// Removing stages.
+	chain.pop_back();
+	chain.pop_back();
+	EXPECT_TRUE(chain.map().is_rigid());
+	p1 = p.mapped_by(stages[0]).mapped_by(stages[1]).mapped_by(correction);
+	p2 = p.mapped_by(chain.map());
+	EXPECT_NEAR(p1.x().value(), p2.x().value(), 1e-12);
+	EXPECT_NEAR(p1.y().value(), p2.y().value(), 1e-12);
+	EXPECT_NEAR(p1.z().value(), p2.z().value(), 1e-12);
+	chain.clear();
+	EXPECT_EQ(0, chain.size());
+
+	// Chain of plane maps.
+	point2<metres> const fp2(1, 2);
+	point2<metres> const q(4, -3);
+	transform_chain<affine_map2<metres,float>,3> chain2;
+	auto const am1 = affine_map2<metres,float>::rotation(fp2,
+		vect1<degrees,float>(30));
+	auto const am2 = affine_map2<metres,float>::translation(
+		vect2<metres,float>(-1, 5));
+	chain2.push_back(am1);
+	chain2.push_back(am2);
+	point2<metres,float> const q1 = point2<metres,float>(q)
+		.mapped_by(am1).mapped_by(am2);
+	point2<metres,float> const q2 = point2<metres,float>(q)
+		.mapped_by(chain2.map());
+	EXPECT_NEAR(q1.x().value(), q2.x().value(), 1e-5);
+	EXPECT_NEAR(q1.y().value(), q2.y().value(), 1e-5);
+}
+
+TEST(unitTest, bulk_map_inversions_and_compositions)
+{
+	int const n = 19;
+	vect3<metres> const dir(0.48, 0.6, 0.64);
+	affine_map3<metres> ams[n], ams2[n], inv_ams[n], comb_ams[n];
+	linear_map3<double> lms[n], lms2[n], inv_lms[n], comb_lms[n];
+	bool singular[n];
+	for (int i = 0; i < n; ++i)
+	{
+		point3<metres> const fp(i, 2 - i, 0.5 * i);
+		ams[i] = i % 3 == 0
+			? affine_map3<metres>::rotation(fp, dir, vect1<degrees>(i * 7))
+			: affine_map3<metres>::scaling(fp, 1 + i, 2, 0.5);
+		ams2[i] = affine_map3<metres>::translation(vect3<metres>(i, 1, 2));
+		lms[i] = i % 3 == 0
+			? linear_map3<double>::rotation(dir, vect1<degrees>(i * 7))
+			: linear_map3<double>::scaling(1 + i, 2, 0.5);
+		lms2[i] = linear_map3<double>::reflection_over_line(dir);
+	}
+	ams[5] = affine_map3<metres>::scaling(point3<metres>(1, 2, 3), 1, 1, 0);
+	lms[7] = linear_map3<double>::scaling(1, 0, 1);
+
+	inverted_n(n, ams, inv_ams, singular);
+	for (int i = 0; i < n; ++i)
+	{
+		EXPECT_EQ(i == 5, singular[i]);
+		EXPECT_EQ(ams[i].is_rigid(), inv_ams[i].is_rigid());
+		auto const expected = ams[i].inverted();
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+			{
+				EXPECT_NEAR(expected.coeff(row, col),
+					inv_ams[i].coeff(row, col), 1e-13);
+			}
+		}
+	}
+	inverted_n(n, lms, inv_lms, singular);
+	for (int i = 0; i < n; ++i)
+	{
+		EXPECT_EQ(i == 7, singular[i]);
+		auto const expected = lms[i].inverted();
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int col = 0; col < 3; ++col)
+			{
+				EXPECT_NEAR(expected.coeff(row, col),
+					inv_lms[i].coeff(row, col), 1e-14);
+			}
+		}
+	}
+
+	combine_n(n, ams, ams2, comb_ams);
+	combine_n(n, lms, lms2, comb_lms);
+	for (int i = 0; i < n; ++i)
+	{
+		auto const expected_am = combine(ams[i], ams2[i]);
+		auto const expected_lm = combine(lms[i], lms2[i]);
+		EXPECT_EQ(expected_am.is_rigid(), comb_ams[i].is_rigid());
+		EXPECT_EQ(expected_lm.is_rigid(), comb_lms[i].is_rigid());
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+			{
+				EXPECT_DOUBLE_EQ(expected_am.coeff(row, col),
+					comb_ams[i].coeff(row, col));
+			}
+			for (int col = 0; col < 3; ++col)
+			{
+				EXPECT_DOUBLE_EQ(expected_lm.coeff(row, col),
+					comb_lms[i].coeff(row, col));
+			}
+		}
+	}
+
+	// In place.
+	combine_n(n, ams, ams2, ams);
+	inverted_n(n, ams, ams, singular);
+	for (int i = 0; i < n; ++i)
+	{
+		EXPECT_EQ(i == 5, singular[i]);
+		auto const expected = comb_ams[i].inverted();
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+			{
+				EXPECT_NEAR(expected.coeff(row, col),
+					ams[i].coeff(row, col), 1e-12);
+			}
+		}
+	}
+}
+
+TEST(unitTest, aligned_vects_and_points)
+{
+	EXPECT_EQ(16u, sizeof (vect3a<metres,float>));
+	EXPECT_EQ(16u, alignof (vect3a<metres,float>));
+	EXPECT_EQ(32u, sizeof (point3a<metres,double>));
+	EXPECT_EQ(32u, alignof (point3a<metres,double>));
+
+	vect3<newtons,float> const f(3, -4, 5);
+	vect3<metres,float> const d(-2, 1.5f, 7);
+	vect3a<newtons,float> const fa(f);
+	vect3a<metres,float> const da(d);
+	EXPECT_TRUE((f == vect3<newtons,float>(fa)));
+	EXPECT_EQ(0, fa.data()[3]);
+	EXPECT_EQ(-4, fa.y().value());
+
+	// Arithmetic.
+	vect3a<metres,float> va = da + da * 2.f - vect3a<metres,float>(1, 2, 3);
+	EXPECT_TRUE((d + d * 2.f - vect3<metres,float>(1, 2, 3)
+		== vect3<metres,float>(va)));
+	va /= 4.f;
+	va += -da;
+	EXPECT_TRUE(((d + d * 2.f - vect3<metres,float>(1, 2, 3)) / 4.f - d
+		== vect3<metres,float>(va)));
+	EXPECT_TRUE(va == va);
+	EXPECT_FALSE(va != va);
+	EXPECT_EQ(0, va.data()[3]);
+
+	// The padding stays zero even dividing by zero,
+	// or multiplying by infinity.
+	float const inf = numeric_limits<float>::infinity();
+	vect3a<metres,float> const by_zero = da / 0.f;
+	EXPECT_EQ(-inf, by_zero.x().value());
+	EXPECT_EQ(0, by_zero.data()[3]);
+	EXPECT_EQ(0, (da * inf).data()[3]);
+	EXPECT_EQ(0, (inf * da).data()[3]);
+	vect3a<metres,float> const huge(inf, 0, 0);
+	EXPECT_EQ(0, huge.mapped_by(
+		linear_map3<float>::scaling(2, 3, 4)).data()[3]);
+
+	// Derived units.
+	vect1<joules,float> const work = fa * da;
+	EXPECT_EQ((f * d).value(), work.value());
+	vect3a<newton_metres,float> const torque = cross_product(fa, da);
+	EXPECT_TRUE((cross_product(f, d)
+		== vect3<newton_metres,float>(torque)));
+	EXPECT_EQ(0, torque.data()[3]);
+	EXPECT_FLOAT_EQ(norm(d).value(), norm(da).value());
+
+	// Maps.
+	auto const lm = linear_map3<float>::rotation(
+		vect3<units,float>(0.48f, 0.6f, 0.64f), vect1<degrees,float>(37));
+	vect3<metres,float> const v1 = vect3<metres,float>(da.mapped_by(lm));
+	vect3<metres,float> const v2 = d.mapped_by(lm);
+	EXPECT_FLOAT_EQ(v2.x().value(), v1.x().value());
+	EXPECT_FLOAT_EQ(v2.y().value(), v1.y().value());
+	EXPECT_FLOAT_EQ(v2.z().value(), v1.z().value());
+
+	point3<metres> const p(7, 8, -9);
+	point3a<metres> pa(p);
+	EXPECT_EQ(p, point3<metres>(pa));
+	auto const am = affine_map3<metres>::rotation(point3<metres>(1, 2, 3),
+		vect3<units>(0.48, 0.6, 0.64), vect1<degrees>(37));
+	point3<metres> const p1 = point3<metres>(pa.mapped_by(am));
+	point3<metres> const p2 = p.mapped_by(am);
+	EXPECT_NEAR(p2.x().value(), p1.x().value(), 1e-14);
+	EXPECT_NEAR(p2.y().value(), p1.y().value(), 1e-14);
+	EXPECT_NEAR(p2.z().value(), p1.z().value(), 1e-14);
+	vect3a<metres> const delta(1, 2, 3);
+	pa += delta;
+	EXPECT_EQ(p + vect3<metres>(1, 2, 3), point3<metres>(pa));
+	EXPECT_EQ(vect3<metres>(1, 2, 3), vect3<metres>(pa - point3a<metres>(p)));
+	pa -= delta;
+	EXPECT_TRUE(pa == point3a<metres>(p));
+	EXPECT_FALSE(pa != point3a<metres>(p));
+}
+
+TEST(unitTest, half_precision_storage)
+{
+	// Exact values, rounding to nearest even, and bit patterns.
+	EXPECT_EQ(0x3C00, float16(1.f).bits());
+	EXPECT_EQ(0xC000, float16(-2.f).bits());
+	EXPECT_EQ(0x7BFF, float16(65504.f).bits());
+	EXPECT_EQ(1.f, float(float16(1.f)));
+	EXPECT_EQ(-0.5f, float(float16(-0.5f)));
+	EXPECT_EQ(2048.f, float(float16(2049.f)));
+	EXPECT_EQ(2052.f, float(float16(2051.f)));
+	EXPECT_EQ(1.f + 1.f / 1024, float(float16(1.f + 1.f / 1024)));
+
+	// Subnormal numbers.
+	float const min_subnormal = 1.f / (1 << 24);
+	EXPECT_EQ(0x0001, float16(min_subnormal).bits());
+	EXPECT_EQ(min_subnormal, float(float16::from_bits(0x0001)));
+	EXPECT_EQ(0x03FF, float16(1023 * min_subnormal).bits());
+	EXPECT_EQ(0x0000, float16(min_subnormal / 2).bits());
+	EXPECT_EQ(0x0002, float16(min_subnormal * 1.5f).bits());
+	EXPECT_EQ(0x8000, float16(-0.f).bits());
+
+	// Overflows, infinities, and NaNs.
+	float const inf = numeric_limits<float>::infinity();
+	EXPECT_EQ(0x7C00, float16(65536.f).bits());
+	EXPECT_EQ(0xFC00, float16(-inf).bits());
+	EXPECT_EQ(inf, float(float16::from_bits(0x7C00)));
+	EXPECT_TRUE(isnan(float(float16(numeric_limits<float>::quiet_NaN()))));
+	EXPECT_TRUE(isnan(float(float16::from_bits(0x7E00))));
+
+	// bfloat16.
+	EXPECT_EQ(0x3F80, bfloat16(1.f).bits());
+	EXPECT_EQ(256.f, float(bfloat16(257.f)));
+	EXPECT_EQ(260.f, float(bfloat16(259.f)));
+	EXPECT_EQ(-inf, float(bfloat16(-inf)));
+	EXPECT_TRUE(isnan(float(bfloat16(numeric_limits<float>::quiet_NaN()))));
+
+	// Measures stored in half precision, computed in float.
+	EXPECT_EQ(6u, sizeof (point3<metres,float16>));
+	EXPECT_EQ(6u, sizeof (vect3<metres,bfloat16>));
+	point3<metres,float16> p1(1, 2, 3);
+	vect3<metres,float16> v1(0.5f, 0.25f, -1);
+	auto p2 = p1 + v1;
+	EXPECT_TRUE((is_same<decltype(p2), point3<metres,float>>::value));
+	EXPECT_EQ(1.5f, p2.x().value());
+	EXPECT_EQ(2.25f, p2.y().value());
+	EXPECT_EQ(2.f, p2.z().value());
+	auto v2 = vect2<metres,bfloat16>(3, 4) * 2.f;
+	EXPECT_TRUE((is_same<decltype(v2), vect2<metres,float>>::value));
+	EXPECT_EQ(8.f, v2.y().value());
+	EXPECT_EQ(5.f, float(norm(vect2<metres,bfloat16>(3, 4)).value()));
+	auto l3 = norm(vect3<metres,float16>(1, 2, 3));
+	EXPECT_TRUE((is_same<decltype(l3), vect1<metres,float16>>::value));
+	EXPECT_EQ(float(float16(sqrt(14.f))), float(l3.value()));
+
+	// Limits.
+	EXPECT_EQ(65504.f, float(numeric_limits<float16>::max()));
+	EXPECT_EQ(-65504.f, float(numeric_limits<float16>::lowest()));
+	EXPECT_EQ(1.f / (1 << 14), float(numeric_limits<float16>::min()));
+	EXPECT_EQ(1.f / 1024, float(numeric_limits<float16>::epsilon()));
+	EXPECT_EQ(min_subnormal, float(numeric_limits<float16>::denorm_min()));
+	EXPECT_EQ(inf, float(numeric_limits<float16>::infinity()));
+	EXPECT_TRUE(isnan(float(numeric_limits<float16>::quiet_NaN())));
+	EXPECT_TRUE(numeric_limits<float16>::digits == 11);
+	EXPECT_EQ(ldexp(255.f, 120), float(numeric_limits<bfloat16>::max()));
+	EXPECT_EQ(1.f / 128, float(numeric_limits<bfloat16>::epsilon()));
+	EXPECT_EQ(numeric_limits<float>::min(),
+		float(numeric_limits<bfloat16>::min()));
+	EXPECT_EQ(-inf, float(-numeric_limits<bfloat16>::infinity()));
+	EXPECT_TRUE(numeric_limits<bfloat16>::digits == 8);
+	p1 += v1;
+	EXPECT_EQ(1.5f, float(p1.x().value()));
+
+	// Bulk widening and narrowing.
+	point3<metres,float> wide[3] = {
+		point3<metres,float>(1, 2, 3),
+		point3<metres,float>(0.1f, -1e5f, 1e-6f),
+		point3<metres,float>(-0.f, 2049, 65504)
+	};
+	point3<metres,float16> narrow[3];
+	point3<metres,float> widened[3];
+	cast_n<float16>(3, wide, narrow);
+	cast_n<float>(3, narrow, widened);
+	EXPECT_EQ(1.f, widened[0].x().value());
+	EXPECT_EQ(3.f, widened[0].z().value());
+	EXPECT_EQ(float(float16(0.1f)), widened[1].x().value());
+	EXPECT_NEAR(0.1f, widened[1].x().value(), 0.0001f);
+	EXPECT_EQ(-inf, widened[1].y().value());
+	EXPECT_NEAR(1e-6f, widened[1].z().value(), 0.00000006f);
+	EXPECT_EQ(2048.f, widened[2].y().value());
+	EXPECT_EQ(65504.f, widened[2].z().value());
+}
+
+TEST(unitTest, integer_unit_conversions)
+{
+	// Exact multiplications and divisions.
+	EXPECT_EQ(1234567000, convert<um>(vect1<mm,int64_t>(1234567)).value());
+	EXPECT_EQ(999999000, convert<nm>(vect1<um,int>(999999)).value());
+	EXPECT_EQ(-1234, convert<mm>(vect1<um,int>(-1234567)).value());
+	EXPECT_EQ(3, convert<mm>(point1<nm,int64_t>(3999999)).value());
+	EXPECT_EQ(25400, convert<um>(vect1<inches,int>(1)).value());
+	EXPECT_EQ(39, convert<inches>(vect1<mm,int>(999)).value());
+	EXPECT_EQ(1000, (unit_conversion_<um,mm>::multiplier()));
+	EXPECT_EQ(1000000, (unit_conversion_<nm,mm>::multiplier()));
+	EXPECT_EQ(0, (unit_conversion_<nm,mm>::divisor()));
+	EXPECT_EQ(1000000, (unit_conversion_<mm,nm>::divisor()));
+	EXPECT_EQ(25400, (unit_conversion_<um,inches>::multiplier()));
+	EXPECT_EQ(0, (unit_conversion_<inches,mm>::multiplier()));
+	EXPECT_EQ(0, (unit_conversion_<inches,mm>::divisor()));
+
+	// Rounding modes.
+	vect1<um,int> const values[] = {
+		vect1<um,int>(1500), vect1<um,int>(2500), vect1<um,int>(-1500),
+		vect1<um,int>(-1499), vect1<um,int>(1501), vect1<um,int>(-3000)
+	};
+	vect1<mm,int> result[6];
+	int const to_nearest[] = { 2, 2, -2, -1, 2, -3 };
+	int const downward[] = { 1, 2, -2, -2, 1, -3 };
+	int const upward[] = { 2, 3, -1, -1, 2, -3 };
+	int const toward_zero[] = { 1, 2, -1, -1, 1, -3 };
+	convert_n(6, values, result, rounding_mode::to_nearest);
+	for (int i = 0; i < 6; ++i) EXPECT_EQ(to_nearest[i], result[i].value());
+	convert_n(6, values, result, rounding_mode::downward);
+	for (int i = 0; i < 6; ++i) EXPECT_EQ(downward[i], result[i].value());
+	convert_n(6, values, result, rounding_mode::upward);
+	for (int i = 0; i < 6; ++i) EXPECT_EQ(upward[i], result[i].value());
+	convert_n(6, values, result);
+	for (int i = 0; i < 6; ++i)
+	{
+		EXPECT_EQ(toward_zero[i], result[i].value());
+	}
+	EXPECT_EQ(-2, convert<mm>(point1<um,int>(-2500),
+		rounding_mode::to_nearest).value());
+	EXPECT_EQ(40, convert<inches>(vect1<mm,int>(1003),
+		rounding_mode::upward).value());
+	EXPECT_EQ(1000, convert<um>(vect1<mm,int>(1),
+		rounding_mode::downward).value());
+	EXPECT_EQ(1.5, convert<mm>(vect1<um,double>(1500),
+		rounding_mode::downward).value());
+
+	// Saturation.
+	int const max_int = numeric_limits<int>::max();
+	int const min_int = numeric_limits<int>::min();
+	EXPECT_EQ(2147483000,
+		convert_saturated<um>(vect1<mm,int>(2147483)).value());
+	EXPECT_EQ(max_int,
+		convert_saturated<um>(vect1<mm,int>(2147484)).value());
+	EXPECT_EQ(min_int,
+		convert_saturated<um>(point1<mm,int>(-2147484)).value());
+	EXPECT_EQ(max_int,
+		convert_saturated<um>(vect1<inches,int>(100000)).value());
+	EXPECT_EQ(2148, convert_saturated<mm>(vect1<um,int>(2147500),
+		rounding_mode::to_nearest).value());
+	point3<mm,int> points[2] = {
+		point3<mm,int>(1, -2, 3), point3<mm,int>(4, 5, 6)
+	};
+	point3<um,int> converted[2];
+	EXPECT_FALSE(convert_saturated_n(2, points, converted));
+	EXPECT_EQ(-2000, converted[0].y().value());
+	EXPECT_EQ(6000, converted[1].z().value());
+	points[1] = point3<mm,int>(4, 3000000, 6);
+	EXPECT_TRUE(convert_saturated_n(2, points, converted));
+	EXPECT_EQ(4000, converted[1].x().value());
+	EXPECT_EQ(max_int, converted[1].y().value());
+	EXPECT_EQ(6000, converted[1].z().value());
+
+	// Units having offsets are scaled, shifted, and rounded once.
+	EXPECT_EQ(37, convert<celsius>(point1<fahrenheit,int>(100)).value());
+	EXPECT_EQ(38, convert<celsius>(point1<fahrenheit,int>(100),
+		rounding_mode::to_nearest).value());
+	EXPECT_EQ(37, convert<celsius>(point1<fahrenheit,int>(100),
+		rounding_mode::downward).value());
+	EXPECT_EQ(-40, convert<celsius>(point1<fahrenheit,int>(-40),
+		rounding_mode::to_nearest).value());
+	EXPECT_EQ(-18, convert<celsius>(point1<fahrenheit,int>(0),
+		rounding_mode::to_nearest).value());
+	EXPECT_EQ(301, convert<kelvin>(point1<celsius,int>(27),
+		rounding_mode::upward).value());
+	EXPECT_EQ(300, convert<kelvin>(point1<celsius,int>(27)).value());
+	EXPECT_EQ(27, convert<celsius>(vect1<kelvin,int>(27)).value());
+
+	// The offset is taken into account by the saturation.
+	EXPECT_EQ(max_int,
+		convert_saturated<kelvin>(point1<celsius,int>(max_int)).value());
+	EXPECT_EQ(min_int, convert_saturated<celsius>(
+		point1<kelvin,int>(min_int + 100)).value());
+	point1<celsius,int> temperatures[2] = {
+		point1<celsius,int>(max_int - 274), point1<celsius,int>(-1000)
+	};
+	point1<kelvin,int> absolute[2];
+	EXPECT_FALSE(convert_saturated_n(2, temperatures, absolute,
+		rounding_mode::upward));
+	EXPECT_EQ(max_int, absolute[0].value());
+	EXPECT_EQ(-726, absolute[1].value());
+	temperatures[0] = point1<celsius,int>(max_int - 273);
+	EXPECT_TRUE(convert_saturated_n(2, temperatures, absolute));
+	EXPECT_EQ(max_int, absolute[0].value());
+
+	// Floating-point values are saturated to their finite limits.
+	EXPECT_EQ(numeric_limits<double>::max(),
+		convert_saturated<nm>(vect1<um,double>(1e307)).value());
+	EXPECT_DOUBLE_EQ(1e9,
+		convert_saturated<nm>(vect1<um,double>(1e6)).value());
+
+	vect2<um,uint16_t> small[1] = { vect2<um,uint16_t>(65, 66) };
+	vect2<nm,uint16_t> large[1];
+	EXPECT_TRUE(convert_saturated_n(1, small, large));
+	EXPECT_EQ(65000, large[0].x().value());
+	EXPECT_EQ(65535, large[0].y().value());
+}
+
+TEST(unitTest, dynamic_converter)
+{
+	dynamic_converter<celsius> from_f(fahrenheit::id());
+	EXPECT_TRUE(from_f.unit() == fahrenheit::id());
+	EXPECT_FLOAT_EQ(50, from_f.vect(90).value());
+	EXPECT_FLOAT_EQ(32.222222, from_f.point(90).value());
+	EXPECT_FLOAT_EQ(90, from_f.value(vect1<celsius>(50)));
+	EXPECT_FLOAT_EQ(90, from_f.value(point1<celsius>(32.222222222)));
+	auto p3 = from_f.point(32, 212, 50);
+	EXPECT_NEAR(0, p3.x().value(), 1e-12);
+	EXPECT_FLOAT_EQ(100, p3.y().value());
+	EXPECT_FLOAT_EQ(10, p3.z().value());
+
+	// Same results of the constructors and functions taking a unit.
+	dynamic_converter<inches,float> from_km(km::id());
+	float values[6] = { 1, 2, 3, 4, 5, 6 };
+	vect2<inches,float> v2[3];
+	from_km.apply(3, values, v2);
+	EXPECT_FLOAT_EQ((vect2<inches,float>(km::id(), 3, 4).x().value()), v2[1].x().value());
+	EXPECT_FLOAT_EQ((vect2<inches,float>(km::id(), 5, 6).y().value()), v2[2].y().value());
+	float back[6];
+	from_km.apply(3, v2, back);
+	for (int i = 0; i < 6; ++i) EXPECT_FLOAT_EQ(values[i], back[i]);
+
+	point1<celsius> p1[2];
+	double t[2] = { 32, 212 };
+	from_f.apply(2, t, p1);
+	EXPECT_FLOAT_EQ(100, p1[1].value());
+	from_f.apply(2, p1, t);
+	EXPECT_FLOAT_EQ(212, t[1]);
+
+	// The same unit keeps the values.
+	dynamic_converter<inches,float> from_in(inches::id());
+	EXPECT_EQ(0.1f, from_in.vect(0.1f).value());
+	EXPECT_EQ(0.1f, from_in.value(point1<inches,float>(0.1f)));
+	point3<inches,float> p3a[2];
+	from_in.apply(2, values, p3a);
+	EXPECT_EQ(6.f, p3a[1].z().value());
+}
+
+#if defined MEASURES_USE_CONSTEXPR
+TEST(unitTest, constant_expressions)
+{
+	// Machine envelope checked at compile time.
+	constexpr point3<metres> low(-0.5, -0.4, 0);
+	constexpr point3<metres> high(1.2, 0.8, 0.6);
+	constexpr vect3<metres> travel = high - low;
+	static_assert(travel.x() < convert<metres>(vect1<km>(0.002)), "");
+	static_assert(convert<inches>(travel).z().value() > 23, "");
+	static_assert(squared_norm_value(travel) < 4.7, "");
+	static_assert(midpoint(low, high).y() == point1<metres>(0.2), "");
+	static_assert(cast<float>(high).z().value() == 0.6f, "");
+	static_assert(convert<celsius>(point1<kelvin>(300)).value() > 26.8, "");
+	static_assert(vect1<metres>(1) * 2 + vect1<metres>(3) == vect1<metres>(5), "");
+	static_assert((vect1<hours>(2) * vect1<km_per_hour>(3)).value() == 6, "");
+
+	constexpr auto fixture = combine(
+		affine_map3<metres>::translation(vect3<metres>(0.1, 0.2, 0.3)),
+		affine_map3<metres>::scaling(point3<metres>(0, 0, 0), 2, 2, 2));
+	static_assert(fixture.coeff(0, 0) == 2, "");
+	static_assert(fixture.coeff(2, 3) == 0.6, "");
+	static_assert(low.mapped_by(fixture).x().value() == -0.8, "");
+	static_assert(convert<km>(fixture).coeff(1, 3) < 0.00041, "");
+
+	constexpr auto proj = linear_map2<>::projection(vect2<units>(1, 0));
+	static_assert(vect2<metres>(3, 4).mapped_by(proj).y().value() == 0, "");
+	static_assert(make_scaling(2, 3).coeff(1, 1) == 3, "");
+	static_assert(linear_map3<>::projection_onto_plane(0., 0., 1.).coeff(2, 2) == 0, "");
+
+	EXPECT_FLOAT_EQ(1.7, travel.x().value());
+}
+#endif
+
 TEST(unitTest, derived_operations)
 {
 	EXPECT_FLOAT_EQ(12.3 * 23.47, (vect1<hours>(12.3) * vect1<km_per_hour>(23.47)).value());
@@ -3552,6 +4867,184 @@ TEST(unitTest, derived_operations)
 	EXPECT_FLOAT_EQ(12.3 * 56.7 - 23.4 * 45.6, a9.z().value());
 }
 
+TEST(unitTest, structures_of_arrays)
+{
+	float x1[3] = { 1, 2, 3 }, y1[3] = { 4, 5, 6 }, z1[3] = { 7, 8, 9 };
+	float x2[3] = { 0.5f, 1, 2 }, y2[3] = { 0, 3, 0 }, z2[3] = { 1, 0, 4 };
+	float x3[3], y3[3], z3[3];
+	vect3_soa<metres,float> v1(3, x1, y1, z1);
+	vect3_soa<metres,float> v2(3, x2, y2, z2);
+	vect3_soa<metres,float> v3(3, x3, y3, z3);
+	point3_soa<metres,float> p1(3, x1, y1, z1);
+	point3_soa<metres,float> p3(3, x3, y3, z3);
+	EXPECT_EQ(3, v1.size());
+
+	// Element proxies.
+	vect3<metres,float> e = v1[1];
+	EXPECT_EQ(2, e.x().value());
+	EXPECT_EQ(8, v1[1].z().value());
+	v3[0] = vect3<metres,float>(10, 20, 30);
+	v3[0] += v1[0];
+	EXPECT_EQ(24, y3[0]);
+	v3[0] *= 2;
+	EXPECT_EQ(74, z3[0]);
+	v3[2] = v1[2];
+	EXPECT_EQ(6, y3[2]);
+	p3[0] = point3<metres,float>(1, 2, 3);
+	p3[0] -= vect3<metres,float>(1, 1, 1);
+	EXPECT_EQ(2, z3[0]);
+	p3[0].x() += vect1<metres,float>(5);
+	EXPECT_EQ(5, x3[0]);
+
+	// Bulk functions.
+	add(v1, v2, v3);
+	EXPECT_EQ(1.5f, x3[0]);
+	EXPECT_EQ(8, y3[1]);
+	subtract(p1, v2, p3);
+	EXPECT_EQ(5, z3[2]);
+	subtract(p1, p3, v3);
+	EXPECT_EQ(4, z3[2]);
+	scale(v1, 2, v3);
+	EXPECT_EQ(18, z3[2]);
+	scale(v3, 0.5f, v3);
+	EXPECT_EQ(9, z3[2]);
+
+	vect1<joules,float> work[3];
+	vect3_soa<newtons,float> forces(3, x2, y2, z2);
+	dot_product(forces, v1, work);
+	EXPECT_FLOAT_EQ(0.5f + 7, work[0].value());
+	EXPECT_FLOAT_EQ(2 + 15, work[1].value());
+
+	vect1<metres,float> norms[3];
+	norm(v2, norms);
+	EXPECT_FLOAT_EQ(sqrt(0.5f * 0.5f + 1), norms[0].value());
+	EXPECT_FLOAT_EQ(sqrt(20.f), norms[2].value());
+	normalized(v2, v3);
+	EXPECT_FLOAT_EQ(2 / sqrt(20.f), x3[2]);
+	EXPECT_FLOAT_EQ(1, norm(vect3<metres,float>(v3[0])).value());
+
+	vect3_soa<km,float> v4(3, x3, y3, z3);
+	convert(v1, v4);
+	EXPECT_FLOAT_EQ(0.003f, x3[2]);
+	point3_soa<km,float> p4(3, x3, y3, z3);
+	convert(p1, p4);
+	EXPECT_FLOAT_EQ(0.009f, z3[2]);
+
+	double x5[3], y5[3], z5[3];
+	vect3_soa<metres,double> v5(3, x5, y5, z5);
+	cast(v2, v5);
+	EXPECT_EQ(0.5, x5[0]);
+	EXPECT_EQ(4, z5[2]);
+
+	auto am = affine_map3<metres,float>::translation(vect3<metres,float>(1, 2, 3));
+	map_points(am, p1, p3);
+	EXPECT_EQ(4, x3[2]);
+	EXPECT_EQ(12, z3[2]);
+	map_vects(linear_map3<float>::scaling(2, 3, 4), v1, v1);
+	EXPECT_EQ(6, x1[2]);
+	EXPECT_EQ(36, z1[2]);
+}
+
+TEST(unitTest, simd_numbers)
+{
+	typedef simd<float,4> sf;
+	float const xs[4] = { 1, 2, 3, 4 };
+	float const ys[4] = { 0, -1, 2, 0.5f };
+	sf const x(xs), y(ys);
+
+	// Every lane is processed like a float.
+	vect3<metres,sf> v1(x, y, 2);
+	vect3<metres,sf> v2 = 2 * v1 - vect3<metres,sf>(1, 1, 1);
+	vect1<metres,sf> n = norm(v2);
+	vect3<metres,sf> u = normalized(v1);
+	auto w = vect3<newtons,sf>(y, x, 0) * v1;
+	for (int i = 0; i < 4; ++i)
+	{
+		vect3<metres,float> v1f(xs[i], ys[i], 2);
+		EXPECT_FLOAT_EQ(norm(2 * v1f - vect3<metres,float>(1, 1, 1)).value(), n.value()[i]);
+		EXPECT_FLOAT_EQ(normalized(v1f).y().value(), u.y().value()[i]);
+		EXPECT_FLOAT_EQ(ys[i] * xs[i] + xs[i] * ys[i], w.value()[i]);
+	}
+
+	// Comparisons return masks.
+	simd_mask<4> m = vect1<metres,sf>(x) < vect1<metres,sf>(2.5f);
+	EXPECT_TRUE(m[0] && m[1] && ! m[2] && ! m[3]);
+	EXPECT_TRUE(all_of(v1 == v1));
+	EXPECT_TRUE(none_of(v1 != v1));
+	EXPECT_TRUE(any_of(point1<metres,sf>(y) == point1<metres,sf>(0)));
+	EXPECT_TRUE(all_of(is_equal(v1, v1 + vect3<metres,sf>(0, 0, 1e-6f), vect1<metres,float>(1e-5f))));
+	EXPECT_EQ(2.5f, select(m, x, sf(2.5f))[3]);
+
+	// Conversions.
+	auto t = convert<celsius>(point1<fahrenheit,sf>(x * 10));
+	EXPECT_FLOAT_EQ((40 - 32) * 5 / 9.f, t.value()[3]);
+
+	// Maps.
+	auto am = affine_map3<metres,sf>::rotation(point3<metres,sf>(y, 0, 1),
+		vect3<metres,sf>(0, 0, 1), vect1<degrees,sf>(x * 90));
+	auto p = point3<metres,sf>(1, 0, 0).mapped_by(am).mapped_by(am.inverted());
+	EXPECT_TRUE(all_of(is_equal(p, point3<metres,sf>(1, 0, 0), vect1<metres,float>(1e-5f))));
+	linear_map2<sf> lm = linear_map2<sf>::scaling(x - 1, 1).inverted();
+	EXPECT_EQ(0, lm.coeff(0, 0)[0]);
+	EXPECT_FLOAT_EQ(1 / 3.f, lm.coeff(0, 0)[3]);
+
+	// Azimuths.
+	signed_azimuth<degrees,sf> a(x * 100);
+	EXPECT_FLOAT_EQ(100, a.value()[0]);
+	EXPECT_FLOAT_EQ(-160, a.value()[1]);
+	EXPECT_FLOAT_EQ(-60, a.value()[2]);
+	unsigned_azimuth<degrees,sf> b(-x * 100);
+	EXPECT_FLOAT_EQ(160, b.value()[1]);
+	EXPECT_FLOAT_EQ(60, (a - signed_azimuth<degrees,sf>(140)).value()[1]);
+	EXPECT_FLOAT_EQ(0.5f, sin(signed_azimuth<degrees,sf>(x * 30))[0]);
+	signed_azimuth<degrees,sf> c(vect2<metres,sf>(0, y));
+	EXPECT_FLOAT_EQ(-90, c.value()[1]);
+}
+
+TEST(unitTest, array_expressions)
+{
+	int const n = 4;
+	point3<metres> p[n], out[n];
+	vect3<metres_per_second> v[n];
+	double k[n];
+	for (int i = 0; i < n; ++i)
+	{
+		p[i] = point3<metres>(i, 2 * i, 3);
+		v[i] = vect3<metres_per_second>(1, -i, 0.5);
+		k[i] = 0.5 * i;
+	}
+	array_span<point3<metres>> ps(n, p), outs(n, out);
+	array_span<vect3<metres_per_second>> vs(n, v);
+	array_span<double> ks(n, k);
+	vect1<seconds> dt(2);
+
+	// Each element is computed by the operators of measures.
+	outs = ps + (vs * dt) * ks;
+	for (int i = 0; i < n; ++i)
+	{
+		auto expected = p[i] + (v[i] * dt) * k[i];
+		EXPECT_EQ(expected.x().value(), out[i].x().value());
+		EXPECT_EQ(expected.y().value(), out[i].y().value());
+		EXPECT_EQ(expected.z().value(), out[i].z().value());
+	}
+
+	// Compound assignment.
+	outs -= vs * dt * ks;
+	EXPECT_EQ(p[3].y().value(), out[3].y().value());
+
+	// Copy of elements.
+	outs = ps;
+	EXPECT_EQ(6, out[3].y().value());
+
+	// Numbers, negation, and promotion.
+	float f[n] = { 1, 2, 3, 4 };
+	double d[n];
+	array_span<float> fs(n, f);
+	array_span<double> ds(n, d);
+	ds = -(2 * fs) / (ks + 1) + 1.5;
+	EXPECT_EQ(-4. / 1.5 + 1.5, d[1]);
+}
+
 /*
 operazioni da testare:
 	trigonometriche
@@ -11,6 +11,9 @@ MEASURES_UNIT(cm, Length, " cm", 0.01, 0)
 
 void f2(double, stringstream&);
 
+// Units have the same identity in every translation unit.
+bool is_km(Length unit) { return unit == km::id(); }
+
 void f1(double a, stringstream& ss)
 {
 	vect3<km> m1(a, a + 1, a + 2);
@@ -2,6 +2,7 @@
 #define MEASURES_USE_IOSTREAMS
 #include "measures.hpp"
 #include <sstream>
+#include <cassert>
 using namespace measures;
 using namespace std;
 
@@ -9,8 +10,11 @@ MEASURES_MAGNITUDE(Length, metres, " m")
 MEASURES_UNIT(cm, Length, " cm", 0.01, 0)
 MEASURES_UNIT(km, Length, " Km", 1000, 0)
 
+bool is_km(Length unit);
+
 void f2(double a, stringstream& ss)
 {
+	assert(is_km(km::id()) && ! is_km(cm::id()));
 	vect3<km> m1(a, a - 1, a - 2);
 	ss << m1 / 2.0;
 	vect3<metres> m2(km::id(), a, a - 1, a - 2);
@@ -38,6 +38,8 @@ int main()
         char const* suf = inches::suffix();
         long double rat = inches::ratio();
         long double off = inches::offset();
+        static_assert(inches::ratio() > 0 && inches::offset() == 0,
+            "unit features must be compile-time constants");
         if (spa2.offset() < 0 || suf == 0 || rat == 0 || off < 0) return 1;
     }
 
@@ -50,6 +52,9 @@ int main()
         long double turn_fr = degrees::turn_fraction<long double>();
         turn_fr = degrees::turn_fraction<double>();
         turn_fr = degrees::turn_fraction<float>();
+        static_assert(degrees::ratio() > 0 && degrees::offset() == 0
+            && degrees::turn_fraction<int>() == 360,
+            "angle unit features must be compile-time constants");
         if (ang2.offset() < 0 || suf == 0 || rat == 0 || off < 0 || turn_fr == 0) return 1;
     }
 